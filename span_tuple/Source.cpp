@@ -1,9 +1,237 @@
 #include "span_tuple.h"
+#include "span_tuple_algorithm.h"
+#include "span_tuple_arena.h"
+#include <algorithm>
 #include <array>
+#include <cstdint>
+#include <cstdlib>
 #include <iostream>
+#include <limits>
+#include <new>
+#include <string>
+#include <tuple>
+#include <vector>
+
+//Unlike assert, still runs in release builds
+#define XK_CHECK(condition) \
+    do { if(!(condition)) { std::cerr << __FILE__ << "(" << __LINE__ << "): check failed: " #condition "\n"; std::abort(); } } while(false)
+
+struct NonTrivial
+{
+    int value = 7;
+};
+
+struct NoDefault
+{
+    explicit NoDefault(int value) : value{ value } {}
+    int value;
+};
+
+void TestArena()
+{
+    xk::monotonic_arena arena{ 1024 };
+    {
+        xk::arena_frame frame{ arena };
+        xk::span_tuple<int, std::dynamic_extent, double, char> scratch = xk::make_span_tuple<int, double, char>(arena, 10, 64);
+        XK_CHECK(scratch.size() == 10);
+        XK_CHECK(reinterpret_cast<std::uintptr_t>(scratch.data<0>()) % 64 == 0);
+        XK_CHECK(reinterpret_cast<std::uintptr_t>(scratch.data<1>()) % 64 == 0);
+        XK_CHECK(reinterpret_cast<std::uintptr_t>(scratch.data<2>()) % 64 == 0);
+
+        xk::span_tuple<NonTrivial, std::dynamic_extent, std::uint8_t> constructed = xk::make_span_tuple<NonTrivial, std::uint8_t>(arena, 3);
+        XK_CHECK(constructed.front<0>().value == 7 && constructed.back<0>().value == 7);
+        XK_CHECK(reinterpret_cast<std::uintptr_t>(constructed.data<0>()) % alignof(NonTrivial) == 0);
+        XK_CHECK(arena.used() > 0);
+    }
+    const size_t highWaterMark = arena.high_water_mark();
+    XK_CHECK(arena.used() == 0);
+    XK_CHECK(highWaterMark >= 10 * (sizeof(int) + sizeof(double) + sizeof(char)));
+
+    XK_CHECK(arena.try_allocate(2048) == nullptr);
+    bool threw = false;
+    try
+    {
+        (void)xk::make_span_tuple<int, int>(arena, 1 << 20);
+    }
+    catch(const std::bad_alloc&)
+    {
+        threw = true;
+    }
+    XK_CHECK(threw);
+
+    threw = false;
+    try
+    {
+        (void)xk::make_span_tuple<int, int>(arena, SIZE_MAX / 2);
+    }
+    catch(const std::bad_alloc&)
+    {
+        threw = true;
+    }
+    XK_CHECK(threw);
+
+    {
+        (void)arena.allocate(100);
+        xk::arena_frame frame{ arena };
+        arena.reset();
+        (void)arena.allocate(300);
+    }
+    XK_CHECK(arena.used() == 0);
+
+    const xk::arena_statistics stats = arena.statistics();
+    XK_CHECK(stats.capacity == 1024);
+    XK_CHECK(stats.high_water_mark == (std::max)(highWaterMark, size_t{ 300 }));
+    XK_CHECK(stats.allocation_count == 4);
+    XK_CHECK(stats.failed_allocation_count == 2);
+    XK_CHECK(stats.reset_count == 1);
+
+    xk::monotonic_arena& threadArena = xk::thread_local_arena<1024>();
+    XK_CHECK(&threadArena == &xk::thread_local_arena<1024>());
+    XK_CHECK(threadArena.capacity() == 1024);
+}
+
+void TestAlgorithms()
+{
+    //Trivially copyable columns (memmove / memset / memcmp) next to a std::string column (std::copy / std::fill / std::equal)
+    std::vector<int> ints{ 1, 2, 3, 4 };
+    std::vector<float> floats{ 1.f, 2.f, 3.f, 4.f };
+    std::vector<std::string> strings{ "a", "b", "c", "d" };
+    std::vector<int> intsCopy(4);
+    std::vector<float> floatsCopy(4);
+    std::vector<std::string> stringsCopy(4);
+    xk::span_tuple<int, std::dynamic_extent, float, std::string> source(ints, floats, strings);
+    xk::span_tuple<int, std::dynamic_extent, float, std::string> destination(intsCopy, floatsCopy, stringsCopy);
+
+    xk::copy(source, destination);
+    XK_CHECK(intsCopy == ints && floatsCopy == floats && stringsCopy == strings);
+    XK_CHECK(xk::equal(source, destination));
+    XK_CHECK(!xk::lexicographical_compare(source, destination) && !xk::lexicographical_compare(destination, source));
+
+    stringsCopy[2] = "a";
+    XK_CHECK(!xk::equal(source, destination));
+    XK_CHECK(xk::lexicographical_compare(destination, source));
+    XK_CHECK(!xk::equal(source, source.first(3)));
+    XK_CHECK(xk::lexicographical_compare(source.first(3), source));
+
+    xk::fill(destination, { 0, 0.f, "x" });
+    XK_CHECK(intsCopy == std::vector<int>(4, 0) && floatsCopy == std::vector<float>(4, 0.f) && stringsCopy == std::vector<std::string>(4, "x"));
+    xk::fill(destination, { -1, 2.5f, "y" });
+    XK_CHECK(intsCopy == std::vector<int>(4, -1) && floatsCopy == std::vector<float>(4, 2.5f) && stringsCopy == std::vector<std::string>(4, "y"));
+
+    //Mixed column types fall back to element wise assignment
+    std::vector<long long> wide(4);
+    std::vector<double> wideFloats(4);
+    xk::copy(xk::span_tuple<const int, std::dynamic_extent, const float>(ints.data(), 4, floats.data()), xk::span_tuple<long long, std::dynamic_extent, double>(wide, wideFloats));
+    XK_CHECK(wide == std::vector<long long>({ 1, 2, 3, 4 }) && wideFloats == std::vector<double>({ 1., 2., 3., 4. }));
+
+    //Overlapping copies behave like memmove for every column type
+    xk::span_tuple<int, std::dynamic_extent, std::string> shifting(ints, strings);
+    xk::copy(shifting.first(3), shifting.last(3));
+    XK_CHECK(ints == std::vector<int>({ 1, 1, 2, 3 }) && strings == std::vector<std::string>({ "a", "a", "b", "c" }));
+    xk::copy(shifting.last(3), shifting.first(3));
+    XK_CHECK(ints == std::vector<int>({ 1, 2, 3, 3 }) && strings == std::vector<std::string>({ "a", "b", "c", "c" }));
+
+    //Unrolled static extents
+    std::array<int, 4> staticInts{ 1, 2, 3, 4 };
+    std::array<std::string, 4> staticStrings{ "a", "b", "c", "d" };
+    std::array<int, 4> staticIntsCopy{};
+    std::array<std::string, 4> staticStringsCopy{};
+    xk::span_tuple<int, 4, std::string> staticSource(staticInts, staticStrings);
+    xk::span_tuple<int, 4, std::string> staticDestination(staticIntsCopy, staticStringsCopy);
+    xk::copy(staticSource, staticDestination);
+    XK_CHECK(staticIntsCopy == staticInts && staticStringsCopy == staticStrings);
+    XK_CHECK(xk::equal(staticSource, staticDestination));
+    staticIntsCopy[3] = 0;
+    XK_CHECK(!xk::equal(staticSource, staticDestination));
+    XK_CHECK(xk::lexicographical_compare(staticDestination, staticSource));
+    xk::fill(staticDestination, { 7, "z" });
+    XK_CHECK((staticIntsCopy == std::array<int, 4>{ 7, 7, 7, 7 }) && staticStringsCopy[3] == "z");
+
+    //Static extents above XK_SPAN_TUPLE_UNROLL_LIMIT use the loop paths
+    std::array<int, 32> largeInts{};
+    std::array<short, 32> largeShorts{};
+    std::array<int, 32> largeIntsCopy{};
+    std::array<short, 32> largeShortsCopy{};
+    xk::span_tuple<int, 32, short> largeStatic(largeInts, largeShorts);
+    xk::span_tuple<int, 32, short> largeStaticCopy(largeIntsCopy, largeShortsCopy);
+    xk::fill(largeStatic, { 3, 4 });
+    xk::copy(largeStatic, largeStaticCopy);
+    XK_CHECK(largeIntsCopy[31] == 3 && largeShortsCopy[31] == 4 && xk::equal(largeStatic, largeStaticCopy));
+
+    //Rows where neither tuple is less are skipped, matching std::lexicographical_compare over std::tuple rows
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    std::array<float, 1> leftFloats{ nan };
+    std::array<int, 1> leftInts{ 1 };
+    std::array<float, 1> rightFloats{ nan };
+    std::array<int, 1> rightInts{ 2 };
+    XK_CHECK(xk::lexicographical_compare(xk::span_tuple<float, 1, int>(leftFloats, leftInts), xk::span_tuple<float, 1, int>(rightFloats, rightInts)) ==
+        (std::tuple(nan, 1) < std::tuple(nan, 2)));
+    XK_CHECK(xk::lexicographical_compare(xk::span_tuple<float, 1, int>(rightFloats, rightInts), xk::span_tuple<float, 1, int>(leftFloats, leftInts)) ==
+        (std::tuple(nan, 2) < std::tuple(nan, 1)));
+    std::vector<float> nanRows{ nan, 1.f };
+    std::vector<int> nanRowInts{ 5, 1 };
+    std::vector<float> nanRowsOther{ nan, 2.f };
+    std::vector<int> nanRowIntsOther{ 5, 1 };
+    XK_CHECK(xk::lexicographical_compare(xk::span_tuple<float, std::dynamic_extent, int>(nanRows, nanRowInts), xk::span_tuple<float, std::dynamic_extent, int>(nanRowsOther, nanRowIntsOther)));
+
+    //Non-temporal stores for columns above XK_SPAN_TUPLE_NON_TEMPORAL_THRESHOLD, written to misaligned destinations
+    constexpr size_t rows = (1 << 20) + 37;
+    std::vector<int> bigInts(rows);
+    std::vector<double> bigDoubles(rows);
+    for(size_t i = 0; i < rows; i++)
+    {
+        bigInts[i] = static_cast<int>(i);
+        bigDoubles[i] = i * 0.5;
+    }
+    std::vector<int> bigIntsCopy(rows + 2);
+    std::vector<double> bigDoublesCopy(rows + 2);
+    xk::span_tuple<int, std::dynamic_extent, double> bigSource(bigInts, bigDoubles);
+    xk::span_tuple<int, std::dynamic_extent, double> bigDestination(bigIntsCopy.data() + 1, rows, bigDoublesCopy.data() + 1);
+    xk::copy(xk::non_temporal, bigSource, bigDestination);
+    XK_CHECK(xk::equal(bigSource, bigDestination));
+    XK_CHECK(bigIntsCopy.front() == 0 && bigIntsCopy.back() == 0 && bigDoublesCopy.back() == 0.);
+    xk::fill(xk::non_temporal, bigDestination, { 5, 1.25 });
+    XK_CHECK(bigIntsCopy[1] == 5 && bigIntsCopy[rows] == 5 && bigDoublesCopy[1] == 1.25 && bigDoublesCopy[rows] == 1.25);
+    XK_CHECK(bigIntsCopy.front() == 0 && bigIntsCopy.back() == 0 && bigDoublesCopy.back() == 0.);
+
+    //Large static extents take the non-temporal path too
+    xk::span_tuple<int, rows, double> bigStaticSource(bigInts.data(), rows, bigDoubles.data());
+    xk::span_tuple<int, rows, double> bigStaticDestination(bigIntsCopy.data() + 1, rows, bigDoublesCopy.data() + 1);
+    xk::copy(xk::non_temporal, bigStaticSource, bigStaticDestination);
+    XK_CHECK(xk::equal(bigStaticSource, bigStaticDestination));
+    xk::fill(xk::non_temporal, bigStaticDestination, { 6, 2.5 });
+    XK_CHECK(bigIntsCopy[1] == 6 && bigIntsCopy[rows] == 6 && bigDoublesCopy[1] == 2.5 && bigDoublesCopy[rows] == 2.5);
+    XK_CHECK(bigIntsCopy.front() == 0 && bigIntsCopy.back() == 0 && bigDoublesCopy.back() == 0.);
+
+    //Non-temporal fills don't need a default constructor
+    std::vector<NoDefault> noDefaults(rows, NoDefault{ 0 });
+    std::vector<int> noDefaultInts(rows);
+    xk::fill(xk::non_temporal, xk::span_tuple<NoDefault, std::dynamic_extent, int>(noDefaults, noDefaultInts), { NoDefault{ 9 }, 1 });
+    XK_CHECK(noDefaults.front().value == 9 && noDefaults.back().value == 9 && noDefaultInts.back() == 1);
+
+    //Equal rows hash equally regardless of extent, different rows and rows of zeros don't collide trivially
+    std::array<int, 4> hashInts{ 1, 2, 1, 0 };
+    std::array<std::string, 4> hashStrings{ "a", "b", "a", "" };
+    xk::span_tuple<int, 4, std::string> hashTable(hashInts, hashStrings);
+    std::array<size_t, 4> staticHashes{};
+    std::vector<size_t> dynamicHashes(4);
+    xk::hash_rows(hashTable, staticHashes);
+    xk::hash_rows(xk::span_tuple<int, std::dynamic_extent, std::string>(hashInts.data(), 4, hashStrings.data()), dynamicHashes);
+    XK_CHECK(std::equal(staticHashes.begin(), staticHashes.end(), dynamicHashes.begin()));
+    XK_CHECK(staticHashes[0] == staticHashes[2] && staticHashes[0] != staticHashes[1]);
+
+    std::array<int, 1> zeros{};
+    std::array<int, 1> moreZeros{};
+    std::array<size_t, 1> zeroHash{};
+    xk::hash_rows(xk::span_tuple<int, 1, int>(zeros, moreZeros), zeroHash);
+    XK_CHECK(zeroHash[0] != 0);
+}
 
 int main()
 {
+    TestArena();
+    TestAlgorithms();
+
     std::array<int, 4> a1 = { 1, 2, 3, 4};
     std::array<float, 4> a2 = { 2.3f, 34.f, 12.3f, 32.f};
     int* ar = a1.data();
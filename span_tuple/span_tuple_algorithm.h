@@ -0,0 +1,463 @@
+//*********************************************************
+//
+// Copyright (c) 2022 Renzy Alarcon
+// Licensed under the MIT License (MIT).
+//
+//*********************************************************
+
+#pragma once
+#include "span_tuple.h"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define XK_SPAN_TUPLE_HAS_SSE2 1
+#else
+#define XK_SPAN_TUPLE_HAS_SSE2 0
+#endif
+
+//Static extents up to this many elements are fully unrolled at compile time
+#ifndef XK_SPAN_TUPLE_UNROLL_LIMIT
+#define XK_SPAN_TUPLE_UNROLL_LIMIT 16
+#endif
+
+//Columns smaller than this many bytes ignore non_temporal and use regular stores
+#ifndef XK_SPAN_TUPLE_NON_TEMPORAL_THRESHOLD
+#define XK_SPAN_TUPLE_NON_TEMPORAL_THRESHOLD (1 << 20)
+#endif
+
+namespace xk
+{
+    //Tag requesting stores that bypass the cache for columns larger than XK_SPAN_TUPLE_NON_TEMPORAL_THRESHOLD bytes
+    struct non_temporal_t
+    {
+        explicit non_temporal_t() = default;
+    };
+
+    inline constexpr non_temporal_t non_temporal{};
+
+    namespace algorithm_detail
+    {
+        template<size_t Extent>
+        inline constexpr bool Is_unrolled_v = Extent != std::dynamic_extent && Extent <= XK_SPAN_TUPLE_UNROLL_LIMIT;
+
+        //Types whose values can be copied and compared as raw bytes
+        template<class Left, class Right>
+        inline constexpr bool Is_bitwise_comparable_v = std::is_same_v<std::remove_cv_t<Left>, std::remove_cv_t<Right>>
+            && std::has_unique_object_representations_v<std::remove_cv_t<Left>>;
+
+        template<class Src, class Dst>
+        inline constexpr bool Is_bitwise_copyable_v = std::is_same_v<std::remove_cv_t<Src>, Dst>
+            && std::is_trivially_copyable_v<Dst>;
+
+        //Types whose value can be read and written as raw bytes without touching padding
+        template<class T>
+        inline constexpr bool Is_bytewise_fillable_v = std::is_trivially_copyable_v<T>
+            && (std::has_unique_object_representations_v<T> || std::is_floating_point_v<T>);
+
+        //Types that can be filled by repeating a 16 byte pattern of their value
+        template<class T>
+        inline constexpr bool Is_pattern_fillable_v = Is_bytewise_fillable_v<T> && 16 % sizeof(T) == 0;
+
+        inline void stream_copy(std::byte* dst, const std::byte* src, size_t bytes) noexcept
+        {
+#if XK_SPAN_TUPLE_HAS_SSE2
+            const size_t head = (std::min)(static_cast<size_t>((16 - (reinterpret_cast<std::uintptr_t>(dst) & 15)) & 15), bytes);
+            std::memcpy(dst, src, head);
+            dst += head;
+            src += head;
+            bytes -= head;
+
+            for(; bytes >= 64; bytes -= 64, dst += 64, src += 64)
+            {
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16));
+                const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 32));
+                const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 48));
+                _mm_stream_si128(reinterpret_cast<__m128i*>(dst), a);
+                _mm_stream_si128(reinterpret_cast<__m128i*>(dst + 16), b);
+                _mm_stream_si128(reinterpret_cast<__m128i*>(dst + 32), c);
+                _mm_stream_si128(reinterpret_cast<__m128i*>(dst + 48), d);
+            }
+            _mm_sfence();
+#endif
+            std::memcpy(dst, src, bytes);
+        }
+
+        template<class T>
+        void stream_fill(T* dst, const T& value, size_t count) noexcept
+        {
+#if XK_SPAN_TUPLE_HAS_SSE2
+            for(; count > 0 && (reinterpret_cast<std::uintptr_t>(dst) & 15) != 0; --count)
+                *dst++ = value;
+
+            constexpr size_t perBlock = 16 / sizeof(T);
+            alignas(16) unsigned char pattern[16];
+            for(size_t i = 0; i < perBlock; i++)
+                std::memcpy(pattern + i * sizeof(T), &value, sizeof(T));
+            const __m128i block = _mm_load_si128(reinterpret_cast<const __m128i*>(pattern));
+
+            for(; count >= perBlock; count -= perBlock, dst += perBlock)
+                _mm_stream_si128(reinterpret_cast<__m128i*>(dst), block);
+            _mm_sfence();
+#endif
+            std::fill(dst, dst + count, value);
+        }
+
+        template<size_t Extent, bool NonTemporal, class Src, class Dst>
+        constexpr void copy_column(Src* src, Dst* dst, size_t count)
+        {
+            if constexpr(Is_bitwise_copyable_v<Src, Dst>)
+            {
+                if(!std::is_constant_evaluated())
+                {
+                    constexpr bool streamable = NonTemporal && (Extent == std::dynamic_extent || Extent * sizeof(Dst) >= XK_SPAN_TUPLE_NON_TEMPORAL_THRESHOLD);
+                    if constexpr(!streamable && Extent != std::dynamic_extent)
+                    {
+                        if constexpr(Extent > 0)
+                            std::memmove(dst, src, Extent * sizeof(Dst));
+                        return;
+                    }
+                    else
+                    {
+                        if(count == 0)
+                            return;
+
+                        const size_t bytes = count * sizeof(Dst);
+                        const auto* srcBytes = reinterpret_cast<const std::byte*>(src);
+                        auto* dstBytes = reinterpret_cast<std::byte*>(dst);
+                        const bool overlaps = dstBytes < srcBytes + bytes && srcBytes < dstBytes + bytes;
+                        if(NonTemporal && !overlaps && bytes >= XK_SPAN_TUPLE_NON_TEMPORAL_THRESHOLD)
+                            stream_copy(dstBytes, srcBytes, bytes);
+                        else
+                            std::memmove(dst, src, bytes);
+                        return;
+                    }
+                }
+            }
+
+            if constexpr(std::is_same_v<std::remove_cv_t<Src>, Dst>)
+            {
+                if(!std::is_constant_evaluated() && std::greater<const Dst*>{}(dst, src) && std::less<const Dst*>{}(dst, src + count))
+                {
+                    std::copy_backward(src, src + count, dst + count);
+                    return;
+                }
+            }
+
+            if constexpr(Is_unrolled_v<Extent>)
+            {
+                [&]<size_t... Indexs>(std::index_sequence<Indexs...>)
+                {
+                    ((dst[Indexs] = src[Indexs]), ...);
+                }(std::make_index_sequence<Extent>());
+            }
+            else
+            {
+                std::copy(src, src + count, dst);
+            }
+        }
+
+        template<size_t Extent, bool NonTemporal, class Dst, class Value>
+        constexpr void fill_column(Dst* dst, const Value& value, size_t count)
+        {
+            if constexpr(std::is_same_v<std::remove_cv_t<Value>, Dst> && Is_bytewise_fillable_v<Dst>)
+            {
+                if(!std::is_constant_evaluated() && count > 0)
+                {
+                    unsigned char bytes[sizeof(Dst)];
+                    std::memcpy(bytes, &value, sizeof(Dst));
+                    const bool uniform = std::all_of(std::begin(bytes), std::end(bytes), [first = bytes[0]](unsigned char b) { return b == first; });
+                    const size_t totalBytes = count * sizeof(Dst);
+
+                    if constexpr(NonTemporal && Is_pattern_fillable_v<Dst>)
+                    {
+                        if(totalBytes >= XK_SPAN_TUPLE_NON_TEMPORAL_THRESHOLD && reinterpret_cast<std::uintptr_t>(dst) % sizeof(Dst) == 0)
+                        {
+                            stream_fill(dst, value, count);
+                            return;
+                        }
+                    }
+
+                    if(uniform)
+                    {
+                        std::memset(static_cast<void*>(dst), bytes[0], totalBytes);
+                        return;
+                    }
+                }
+            }
+
+            if constexpr(Is_unrolled_v<Extent>)
+            {
+                [&]<size_t... Indexs>(std::index_sequence<Indexs...>)
+                {
+                    ((dst[Indexs] = value), ...);
+                }(std::make_index_sequence<Extent>());
+            }
+            else
+            {
+                std::fill(dst, dst + count, value);
+            }
+        }
+
+        template<size_t Extent, class Left, class Right>
+        constexpr bool equal_column(Left* left, Right* right, size_t count)
+        {
+            if constexpr(Is_bitwise_comparable_v<Left, Right>)
+            {
+                if(!std::is_constant_evaluated())
+                {
+                    if constexpr(Extent != std::dynamic_extent)
+                        return Extent == 0 || std::memcmp(left, right, Extent * sizeof(Left)) == 0;
+                    else
+                        return count == 0 || std::memcmp(left, right, count * sizeof(Left)) == 0;
+                }
+            }
+
+            if constexpr(Is_unrolled_v<Extent>)
+            {
+                return [&]<size_t... Indexs>(std::index_sequence<Indexs...>)
+                {
+                    return ((left[Indexs] == right[Indexs]) && ...);
+                }(std::make_index_sequence<Extent>());
+            }
+            else
+            {
+                return std::equal(left, left + count, right);
+            }
+        }
+
+        //Gets the index of the first element in [start, limit) that differs between both columns, or limit if there is none
+        template<size_t Extent, class Left, class Right>
+        constexpr size_t mismatch_column(Left* left, Right* right, size_t start, size_t limit)
+        {
+            if constexpr(Is_unrolled_v<Extent>)
+            {
+                size_t result = limit;
+                [&]<size_t... Indexs>(std::index_sequence<Indexs...>)
+                {
+                    (void)((Indexs >= start && Indexs < limit && !(left[Indexs] == right[Indexs]) && (result = Indexs, true)) || ...);
+                }(std::make_index_sequence<Extent>());
+                return result;
+            }
+            else
+            {
+                return static_cast<size_t>(std::mismatch(left + start, left + limit, right + start).first - left);
+            }
+        }
+
+        constexpr std::uint64_t mix(std::uint64_t value) noexcept
+        {
+            value ^= value >> 33;
+            value *= 0xff51afd7ed558ccdull;
+            value ^= value >> 33;
+            return value;
+        }
+
+        //Starting state of every row hash, so rows of zeros don't hash to 0
+        inline constexpr std::uint64_t Hash_offset = 0xcbf29ce484222325ull;
+
+        template<class T>
+        constexpr std::uint64_t hash_element(const T& value)
+        {
+            using type = std::remove_cv_t<T>;
+            if constexpr((std::is_integral_v<type> || std::is_enum_v<type> || std::is_pointer_v<type>) && sizeof(type) <= sizeof(std::uint64_t))
+            {
+                if constexpr(std::is_pointer_v<type>)
+                    return mix(static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(value)));
+                else if constexpr(std::is_enum_v<type>)
+                    return mix(static_cast<std::uint64_t>(static_cast<std::underlying_type_t<type>>(value)));
+                else
+                    return mix(static_cast<std::uint64_t>(value));
+            }
+            else
+            {
+                return mix(static_cast<std::uint64_t>(std::hash<type>{}(value)));
+            }
+        }
+
+        constexpr std::uint64_t hash_combine(std::uint64_t seed, std::uint64_t hash) noexcept
+        {
+            return (seed ^ hash) * 0x9e3779b97f4a7c15ull;
+        }
+
+        template<size_t Extent, class T>
+        constexpr void hash_column(T* column, size_t* out, size_t count)
+        {
+            if constexpr(Is_unrolled_v<Extent>)
+            {
+                [&]<size_t... Indexs>(std::index_sequence<Indexs...>)
+                {
+                    ((out[Indexs] = static_cast<size_t>(hash_combine(out[Indexs], hash_element(column[Indexs])))), ...);
+                }(std::make_index_sequence<Extent>());
+            }
+            else
+            {
+                for(size_t i = 0; i < count; i++)
+                    out[i] = static_cast<size_t>(hash_combine(out[i], hash_element(column[i])));
+            }
+        }
+
+        template<bool NonTemporal, class SrcFirst, size_t SrcExtent, class... SrcTy, class DstFirst, size_t DstExtent, class... DstTy, size_t... Indexs>
+        constexpr void copy_impl(const span_tuple<SrcFirst, SrcExtent, SrcTy...>& src, const span_tuple<DstFirst, DstExtent, DstTy...>& dst, std::index_sequence<Indexs...>)
+        {
+            (copy_column<SrcExtent, NonTemporal>(std::get<Indexs>(src.data()), std::get<Indexs>(dst.data()), src.size()), ...);
+        }
+
+        template<bool NonTemporal, class First, size_t Extent, class... Ty, class Value, size_t... Indexs>
+        constexpr void fill_impl(const span_tuple<First, Extent, Ty...>& dst, const Value& value, std::index_sequence<Indexs...>)
+        {
+            (fill_column<Extent, NonTemporal>(std::get<Indexs>(dst.data()), std::get<Indexs>(value), dst.size()), ...);
+        }
+
+        template<size_t Extent, class LeftFirst, size_t LeftExtent, class... LeftTy, class RightFirst, size_t RightExtent, class... RightTy, size_t... Indexs>
+        constexpr bool equal_impl(const span_tuple<LeftFirst, LeftExtent, LeftTy...>& left, const span_tuple<RightFirst, RightExtent, RightTy...>& right, std::index_sequence<Indexs...>)
+        {
+            return (equal_column<Extent>(std::get<Indexs>(left.data()), std::get<Indexs>(right.data()), left.size()) && ...);
+        }
+
+        template<size_t Extent, class LeftFirst, size_t LeftExtent, class... LeftTy, class RightFirst, size_t RightExtent, class... RightTy, size_t... Indexs>
+        constexpr size_t mismatch_impl(const span_tuple<LeftFirst, LeftExtent, LeftTy...>& left, const span_tuple<RightFirst, RightExtent, RightTy...>& right, size_t start, size_t limit, std::index_sequence<Indexs...>)
+        {
+            ((limit = mismatch_column<Extent>(std::get<Indexs>(left.data()), std::get<Indexs>(right.data()), start, limit)), ...);
+            return limit;
+        }
+
+        template<class First, size_t Extent, class... Ty, size_t... Indexs>
+        constexpr void hash_rows_impl(const span_tuple<First, Extent, Ty...>& table, size_t* out, std::index_sequence<Indexs...>)
+        {
+            (hash_column<Extent>(std::get<Indexs>(table.data()), out, table.size()), ...);
+        }
+
+        template<size_t LeftExtent, size_t RightExtent>
+        inline constexpr size_t Common_extent_v = LeftExtent != std::dynamic_extent ? LeftExtent : RightExtent;
+    }
+
+    /// <summary>
+    /// Copies every column of src into dst. Columns of the same trivially copyable type are copied with memmove,
+    /// small static extents are fully unrolled. Overlapping columns of the same type are supported outside of
+    /// constant evaluation, columns of different types must not overlap
+    /// </summary>
+    /// <param name="src"> The columns to copy from </param>
+    /// <param name="dst"> The columns to copy to. Must be at least as large as src </param>
+    template<class SrcFirst, size_t SrcExtent, class... SrcTy, class DstFirst, size_t DstExtent, class... DstTy>
+        requires (sizeof...(SrcTy) == sizeof...(DstTy))
+    constexpr void copy(const span_tuple<SrcFirst, SrcExtent, SrcTy...>& src, const span_tuple<DstFirst, DstExtent, DstTy...>& dst)
+    {
+        if constexpr(SrcExtent != std::dynamic_extent && DstExtent != std::dynamic_extent)
+        {
+            static_assert(SrcExtent <= DstExtent, "Destination is too small in xk::copy()");
+        }
+        assert(src.size() <= dst.size() && "Destination is too small in xk::copy()");
+
+        algorithm_detail::copy_impl<false>(src, dst, std::make_index_sequence<sizeof...(SrcTy) + 1>());
+    }
+
+    /// <summary>
+    /// Same as copy, but columns larger than XK_SPAN_TUPLE_NON_TEMPORAL_THRESHOLD bytes are written with
+    /// non-temporal stores so large snapshots don't evict the working set from the cache
+    /// </summary>
+    template<class SrcFirst, size_t SrcExtent, class... SrcTy, class DstFirst, size_t DstExtent, class... DstTy>
+        requires (sizeof...(SrcTy) == sizeof...(DstTy))
+    void copy(non_temporal_t, const span_tuple<SrcFirst, SrcExtent, SrcTy...>& src, const span_tuple<DstFirst, DstExtent, DstTy...>& dst)
+    {
+        if constexpr(SrcExtent != std::dynamic_extent && DstExtent != std::dynamic_extent)
+        {
+            static_assert(SrcExtent <= DstExtent, "Destination is too small in xk::copy()");
+        }
+        assert(src.size() <= dst.size() && "Destination is too small in xk::copy()");
+
+        algorithm_detail::copy_impl<true>(src, dst, std::make_index_sequence<sizeof...(SrcTy) + 1>());
+    }
+
+    /// <summary>
+    /// Assigns each element of value to every element of the matching column. Uses memset when
+    /// the value's bytes are all the same, small static extents are fully unrolled
+    /// </summary>
+    /// <param name="dst"> The columns to fill </param>
+    /// <param name="value"> One value per column </param>
+    template<class First, size_t Extent, class... Ty>
+    constexpr void fill(const span_tuple<First, Extent, Ty...>& dst, const typename span_tuple<First, Extent, Ty...>::value_type& value)
+    {
+        algorithm_detail::fill_impl<false>(dst, value, std::make_index_sequence<sizeof...(Ty) + 1>());
+    }
+
+    /// <summary>
+    /// Same as fill, but columns larger than XK_SPAN_TUPLE_NON_TEMPORAL_THRESHOLD bytes are written with non-temporal stores
+    /// </summary>
+    template<class First, size_t Extent, class... Ty>
+    void fill(non_temporal_t, const span_tuple<First, Extent, Ty...>& dst, const typename span_tuple<First, Extent, Ty...>::value_type& value)
+    {
+        algorithm_detail::fill_impl<true>(dst, value, std::make_index_sequence<sizeof...(Ty) + 1>());
+    }
+
+    /// <summary>
+    /// Checks if both span_tuples have the same size and every column compares equal.
+    /// Columns of the same type with unique object representations are compared with memcmp
+    /// </summary>
+    template<class LeftFirst, size_t LeftExtent, class... LeftTy, class RightFirst, size_t RightExtent, class... RightTy>
+        requires (sizeof...(LeftTy) == sizeof...(RightTy))
+    XK_SPAN_TUPLE_NODISCARD constexpr bool equal(const span_tuple<LeftFirst, LeftExtent, LeftTy...>& left, const span_tuple<RightFirst, RightExtent, RightTy...>& right)
+    {
+        if constexpr(LeftExtent != std::dynamic_extent && RightExtent != std::dynamic_extent && LeftExtent != RightExtent)
+        {
+            return false;
+        }
+        else
+        {
+            if(left.size() != right.size())
+                return false;
+
+            return algorithm_detail::equal_impl<algorithm_detail::Common_extent_v<LeftExtent, RightExtent>>(left, right, std::make_index_sequence<sizeof...(LeftTy) + 1>());
+        }
+    }
+
+    /// <summary>
+    /// Lexicographically compares the rows of both span_tuples, where rows are compared like std::tuples.
+    /// Candidate rows are found one column at a time with operator==, rows where neither tuple is less are skipped
+    /// </summary>
+    template<class LeftFirst, size_t LeftExtent, class... LeftTy, class RightFirst, size_t RightExtent, class... RightTy>
+        requires (sizeof...(LeftTy) == sizeof...(RightTy))
+    XK_SPAN_TUPLE_NODISCARD constexpr bool lexicographical_compare(const span_tuple<LeftFirst, LeftExtent, LeftTy...>& left, const span_tuple<RightFirst, RightExtent, RightTy...>& right)
+    {
+        constexpr size_t extent = LeftExtent == RightExtent ? LeftExtent : std::dynamic_extent;
+        const size_t count = (std::min)(left.size(), right.size());
+        constexpr auto columns = std::make_index_sequence<sizeof...(LeftTy) + 1>();
+
+        for(size_t row = 0; (row = algorithm_detail::mismatch_impl<extent>(left, right, row, count, columns)) != count; row++)
+        {
+            if(left[row] < right[row])
+                return true;
+            if(right[row] < left[row])
+                return false;
+        }
+
+        return left.size() < right.size();
+    }
+
+    /// <summary>
+    /// Hashes every row into out with a scalar loop per column over contiguous memory.
+    /// Integral, enum and pointer columns are mixed inline, other types go through std::hash
+    /// </summary>
+    /// <param name="table"> The rows to hash </param>
+    /// <param name="out"> Receives one hash per row. Must be the same size as table </param>
+    /// <param name="seed"> The initial value of every hash </param>
+    template<class First, size_t Extent, class... Ty>
+    constexpr void hash_rows(const span_tuple<First, Extent, Ty...>& table, std::span<size_t> out, size_t seed = 0)
+    {
+        assert(out.size() == table.size() && "out must have one element per row in xk::hash_rows()");
+
+        std::fill(out.begin(), out.end(), static_cast<size_t>(seed ^ algorithm_detail::Hash_offset));
+        algorithm_detail::hash_rows_impl(table, out.data(), std::make_index_sequence<sizeof...(Ty) + 1>());
+    }
+}
@@ -0,0 +1,238 @@
+//*********************************************************
+//
+// Copyright (c) 2022 Renzy Alarcon
+// Licensed under the MIT License (MIT).
+//
+//*********************************************************
+
+#pragma once
+#include "span_tuple.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <span>
+#include <utility>
+
+namespace xk
+{
+    //Usage numbers of a monotonic_arena, used to size arenas from real workloads
+    struct arena_statistics
+    {
+        size_t capacity = 0;
+        size_t used = 0;
+        size_t high_water_mark = 0;
+        size_t allocation_count = 0;
+        size_t failed_allocation_count = 0;
+        size_t reset_count = 0;
+    };
+
+    /// <summary>
+    /// A fixed capacity bump allocator. Allocations are never freed individually,
+    /// the whole arena is released at once with reset() or an arena_frame. No destructors are ever run
+    /// </summary>
+    class monotonic_arena
+    {
+    public:
+        /// <summary>
+        /// Owning constructor, allocates a buffer of capacity bytes up front
+        /// </summary>
+        /// <param name="capacity"> The size of the buffer in bytes </param>
+        explicit monotonic_arena(size_t capacity) :
+            m_storage{ std::make_unique_for_overwrite<std::byte[]>(capacity) },
+            m_buffer{ m_storage.get() },
+            m_capacity{ capacity }
+        {
+        }
+
+        /// <summary>
+        /// Non-owning constructor, bump allocates out of a buffer supplied by the caller
+        /// </summary>
+        /// <param name="buffer"> The memory to allocate from. Must outlive the arena </param>
+        explicit monotonic_arena(std::span<std::byte> buffer) noexcept :
+            m_buffer{ buffer.data() },
+            m_capacity{ buffer.size() }
+        {
+        }
+
+        monotonic_arena(const monotonic_arena&) = delete;
+        monotonic_arena& operator=(const monotonic_arena&) = delete;
+
+    public:
+        /// <summary>
+        /// Carves out size bytes aligned to alignment. Returns nullptr if the arena does not have enough space left
+        /// </summary>
+        /// <param name="size"> The number of bytes to allocate </param>
+        /// <param name="alignment"> The alignment of the allocation, must be a power of 2 </param>
+        XK_SPAN_TUPLE_NODISCARD std::byte* try_allocate(size_t size, size_t alignment = alignof(std::max_align_t)) noexcept
+        {
+            assert(std::has_single_bit(alignment) && "alignment must be a power of 2");
+
+            const std::uintptr_t current = reinterpret_cast<std::uintptr_t>(m_buffer + m_used);
+            const size_t padding = static_cast<size_t>((alignment - (current & (alignment - 1))) & (alignment - 1));
+            const size_t remaining = m_capacity - m_used;
+            if(padding > remaining || size > remaining - padding)
+            {
+                ++m_failedAllocationCount;
+                return nullptr;
+            }
+
+            std::byte* allocation = m_buffer + m_used + padding;
+            m_used += padding + size;
+            m_highWaterMark = (std::max)(m_highWaterMark, m_used);
+            ++m_allocationCount;
+            return allocation;
+        }
+
+        /// <summary>
+        /// Carves out size bytes aligned to alignment. Throws std::bad_alloc if the arena does not have enough space left
+        /// </summary>
+        /// <param name="size"> The number of bytes to allocate </param>
+        /// <param name="alignment"> The alignment of the allocation, must be a power of 2 </param>
+        XK_SPAN_TUPLE_NODISCARD std::byte* allocate(size_t size, size_t alignment = alignof(std::max_align_t))
+        {
+            std::byte* allocation = try_allocate(size, alignment);
+            if(allocation == nullptr)
+                throw std::bad_alloc();
+            return allocation;
+        }
+
+        //Releases every allocation at once. The high water mark is kept so it covers the arena's whole lifetime.
+        //Any arena_frame still alive will empty the arena again when it is destroyed
+        void reset() noexcept
+        {
+            m_used = 0;
+            ++m_resetCount;
+        }
+
+        //Gets the number of bytes currently allocated, including alignment padding
+        size_t used() const noexcept { return m_used; }
+
+        //Gets the size of the buffer in bytes
+        size_t capacity() const noexcept { return m_capacity; }
+
+        //Gets the most bytes that were ever allocated at once
+        size_t high_water_mark() const noexcept { return m_highWaterMark; }
+
+        arena_statistics statistics() const noexcept
+        {
+            return { m_capacity, m_used, m_highWaterMark, m_allocationCount, m_failedAllocationCount, m_resetCount };
+        }
+
+    private:
+        friend class arena_frame;
+
+        void rewind(size_t used, size_t resetCount) noexcept
+        {
+            m_used = resetCount == m_resetCount ? used : 0;
+        }
+
+    private:
+        std::unique_ptr<std::byte[]> m_storage;
+        std::byte* m_buffer = nullptr;
+        size_t m_capacity = 0;
+        size_t m_used = 0;
+        size_t m_highWaterMark = 0;
+        size_t m_allocationCount = 0;
+        size_t m_failedAllocationCount = 0;
+        size_t m_resetCount = 0;
+    };
+
+    /// <summary>
+    /// Scoped frame over a monotonic_arena. Everything allocated from the arena while the frame is alive
+    /// is released when the frame is destroyed. Frames can nest, but must be destroyed in reverse order.
+    /// If the arena was reset while the frame was alive, destroying the frame empties the arena instead
+    /// </summary>
+    class arena_frame
+    {
+    public:
+        explicit arena_frame(monotonic_arena& arena) noexcept :
+            m_arena{ arena },
+            m_mark{ arena.used() },
+            m_resetCount{ arena.statistics().reset_count }
+        {
+        }
+
+        arena_frame(const arena_frame&) = delete;
+        arena_frame& operator=(const arena_frame&) = delete;
+
+        ~arena_frame()
+        {
+            m_arena.rewind(m_mark, m_resetCount);
+        }
+
+        monotonic_arena& arena() const noexcept { return m_arena; }
+
+    private:
+        monotonic_arena& m_arena;
+        size_t m_mark;
+        size_t m_resetCount;
+    };
+
+    //Gets an arena of Capacity bytes owned by the calling thread. Each Capacity gets its own arena
+    template<size_t Capacity>
+    monotonic_arena& thread_local_arena()
+    {
+        thread_local monotonic_arena arena{ Capacity };
+        return arena;
+    }
+
+    namespace arena_detail
+    {
+        template<class T>
+        T* start_column(std::byte* storage, size_t count)
+        {
+            T* column = reinterpret_cast<T*>(storage);
+            if constexpr(!std::is_trivially_default_constructible_v<T>)
+            {
+                std::uninitialized_default_construct_n(column, count);
+            }
+            return column;
+        }
+
+        template<class First, class... Ty, size_t... Indexs>
+        span_tuple<First, std::dynamic_extent, Ty...> make_span_tuple_impl(std::byte* storage, const std::array<size_t, sizeof...(Ty) + 1>& offsets, size_t count, std::index_sequence<Indexs...>)
+        {
+            return span_tuple<First, std::dynamic_extent, Ty...>{ start_column<First>(storage + offsets[0], count), count, start_column<Ty>(storage + offsets[Indexs + 1], count)... };
+        }
+    }
+
+    /// <summary>
+    /// Allocates every column of a span_tuple out of an arena with a single bump allocation.
+    /// Trivial types are left uninitialized, other types are default constructed
+    /// </summary>
+    /// <param name="arena"> The arena to allocate from </param>
+    /// <param name="count"> The number of elements in each column </param>
+    /// <param name="alignment"> The minimum alignment of each column, must be 0 or a power of 2. Columns are always at least naturally aligned </param>
+    template<class First, class... Ty>
+    XK_SPAN_TUPLE_NODISCARD span_tuple<First, std::dynamic_extent, Ty...> make_span_tuple(monotonic_arena& arena, size_t count, size_t alignment = 0)
+    {
+        static_assert(std::is_trivially_destructible_v<First> && (std::is_trivially_destructible_v<Ty> && ...),
+            "monotonic_arena never runs destructors, columns must be trivially destructible");
+        assert((alignment == 0 || std::has_single_bit(alignment)) && "alignment must be 0 or a power of 2");
+
+        constexpr size_t columnCount = sizeof...(Ty) + 1;
+        constexpr std::array<size_t, columnCount> sizes{ sizeof(First), sizeof(Ty)... };
+        const std::array<size_t, columnCount> alignments{ (std::max)(alignment, alignof(First)), (std::max)(alignment, alignof(Ty))... };
+
+        std::array<size_t, columnCount> offsets{};
+        size_t total = 0;
+        for(size_t i = 0; i < columnCount; i++)
+        {
+            total = (total + alignments[i] - 1) & ~(alignments[i] - 1);
+            if(count > (std::numeric_limits<size_t>::max() - total) / sizes[i])
+                throw std::bad_alloc();
+
+            offsets[i] = total;
+            total += sizes[i] * count;
+        }
+
+        std::byte* storage = arena.allocate(total, *std::max_element(alignments.begin(), alignments.end()));
+        return arena_detail::make_span_tuple_impl<First, Ty...>(storage, offsets, count, std::make_index_sequence<sizeof...(Ty)>());
+    }
+}